@@ -0,0 +1,96 @@
+#! /usr/bin/env python3
+#
+# Copyright BitBake Contributors
+#
+# SPDX-License-Identifier: MIT
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.dirname(os.path.abspath(__file__))), "lib"))
+
+import bb.build
+import bb.event
+from bb.server.process import ConnectionReader, ConnectionWriter
+
+
+def writer(fd, count, batch):
+    conn = ConnectionWriter(fd)
+    events = []
+    for i in range(count):
+        event = bb.build.TaskProgress(i % 100)
+        event.pid = i % 8
+        if batch == 1:
+            conn.send(event)
+            continue
+        events.append(event)
+        if len(events) == batch:
+            conn.sendbatch(bb.event.EventBatch(events))
+            events = []
+    if events:
+        conn.sendbatch(bb.event.EventBatch(events))
+    conn.close()
+
+
+def run(count, batch):
+    r, w = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        os.close(r)
+        try:
+            writer(w, count, batch)
+        finally:
+            os._exit(0)
+    os.close(w)
+
+    reader = ConnectionReader(r)
+    received = 0
+    start_time = time.monotonic()
+    while received < count:
+        event = reader.get()
+        if isinstance(event, bb.event.EventBatch):
+            received += len(event)
+        else:
+            received += 1
+    elapsed = time.monotonic() - start_time
+    reader.close()
+    os.waitpid(pid, 0)
+    return elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Bitbake UI event pipe throughput benchmark",
+        epilog="""
+        Sends TaskProgress events from a forked writer to a reader over the
+        server's event connection, one message per event and then as
+        EventBatch messages of each given size, and reports the events per
+        second received. Events are not coalesced, so this measures the
+        transport alone.
+        """,
+    )
+    parser.add_argument(
+        "--count", type=int, default=100000, help="Number of events to send per run"
+    )
+    parser.add_argument(
+        "--batch",
+        type=int,
+        nargs="+",
+        default=[16, 64, 256],
+        help="Batch sizes to compare against sending single events",
+    )
+
+    args = parser.parse_args()
+
+    print("%-10s %12s %12s" % ("batch", "seconds", "events/s"))
+    for batch in [1] + args.batch:
+        elapsed = run(args.count, batch)
+        print("%-10d %12.3f %12.0f" % (batch, elapsed, args.count / elapsed))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,78 @@
+#! /usr/bin/env python3
+#
+# Copyright BitBake Contributors
+#
+# SPDX-License-Identifier: MIT
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Bitbake server configuration switch benchmark",
+        epilog="""
+        Parses the metadata for each MACHINE given, back to back, against one
+        memory resident bitbake server and reports the time each parse took.
+        Run it twice over the same machines with and without
+        BB_SERVER_RESIDENT_CACHES set to see the effect of keeping recipe
+        caches resident.
+        """,
+    )
+    parser.add_argument("machines", nargs="+", help="MACHINE values to parse for")
+    parser.add_argument(
+        "--rounds", type=int, default=2, help="Number of passes over the machines"
+    )
+    parser.add_argument(
+        "--timeout", default="600", help="Server idle timeout (BB_SERVER_TIMEOUT)"
+    )
+
+    args = parser.parse_args()
+
+    if not "BUILDDIR" in os.environ:
+        print(
+            "'BUILDDIR' not found in the environment. Did you initialize the build environment?"
+        )
+        return 1
+
+    os.chdir(os.environ["BUILDDIR"])
+
+    env = os.environ.copy()
+    env["BB_SERVER_TIMEOUT"] = args.timeout
+    env["BB_ENV_PASSTHROUGH_ADDITIONS"] = " ".join(
+        (env.get("BB_ENV_PASSTHROUGH_ADDITIONS", "") + " MACHINE").split()
+    )
+
+    results = {}
+    try:
+        for run in range(args.rounds):
+            for machine in args.machines:
+                env["MACHINE"] = machine
+                start_time = time.monotonic()
+                r = subprocess.run(
+                    ["bitbake", "-p"], env=env, stdout=subprocess.DEVNULL
+                )
+                elapsed = time.monotonic() - start_time
+                if r.returncode != 0:
+                    print("Parsing for %s exited with %d" % (machine, r.returncode))
+                    return 1
+                results.setdefault(machine, []).append(elapsed)
+                print("round %d %-20s %8.2fs" % (run + 1, machine, elapsed))
+    finally:
+        subprocess.run(["bitbake", "-m"], env=env, stdout=subprocess.DEVNULL)
+
+    print()
+    print("%-20s %s" % ("MACHINE", " ".join("%9s" % ("round %d" % (i + 1)) for i in range(args.rounds))))
+    for machine, times in results.items():
+        print("%-20s %s" % (machine, " ".join("%8.2fs" % t for t in times)))
+    total = [sum(t[i] for t in results.values()) for i in range(args.rounds)]
+    print("%-20s %s" % ("total", " ".join("%8.2fs" % t for t in total)))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
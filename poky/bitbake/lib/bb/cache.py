@@ -19,7 +19,7 @@
 import os
 import logging
 import pickle
-from collections import defaultdict
+from collections import defaultdict, OrderedDict
 from collections.abc import Mapping
 import bb.utils
 from bb import PrefixLoggerAdapter
@@ -30,6 +30,12 @@ logger = logging.getLogger("BitBake.Cache")
 
 __cache_version__ = "155"
 
+# Recipe caches already loaded by this (memory resident) server, keyed by the
+# identity of the cache files they were loaded from. Lets a server switching
+# between configurations (e.g. different MACHINEs) skip reloading a cache it
+# has seen before. Bounded by BB_SERVER_RESIDENT_CACHES, disabled by default.
+resident_caches = OrderedDict()
+
 def getCacheFile(path, filename, mc, data_hash):
     mcspec = ''
     if mc:
@@ -464,7 +470,46 @@ class Cache(object):
 
         return cachesize
 
+    def resident_key(self):
+        key = []
+        for cache_class in self.caches_array:
+            cachefile = self.getCacheFile(cache_class.cachefile)
+            try:
+                st = os.stat(cachefile)
+            except OSError:
+                return None
+            key.append((cachefile, st.st_ino, st.st_mtime_ns, st.st_size))
+        return tuple(key)
+
     def load_cachefile(self, progress):
+        limit = self.data.getVar("BB_SERVER_RESIDENT_CACHES") or "0"
+        try:
+            limit = max(0, int(limit))
+        except ValueError:
+            bb.fatal("BB_SERVER_RESIDENT_CACHES must be an integer, not '%s'" % limit)
+        # The limit may have been lowered (or zeroed) since the caches were
+        # kept, so always drop whatever no longer fits
+        while len(resident_caches) > limit:
+            resident_caches.popitem(last=False)
+
+        key = self.resident_key() if limit > 0 else None
+        if key and key in resident_caches:
+            self.logger.debug("Using resident cache for %s" % self.cachefile)
+            resident_caches.move_to_end(key)
+            # Entries get replaced or removed as recipes are revalidated, so
+            # hand out a copy of the mapping
+            self.depends_cache = dict(resident_caches[key])
+            progress(self.cachesize())
+            return len(self.depends_cache)
+
+        loaded = self._load_cachefile(progress)
+        if key and loaded:
+            resident_caches[key] = dict(self.depends_cache)
+            while len(resident_caches) > limit:
+                resident_caches.popitem(last=False)
+        return loaded
+
+    def _load_cachefile(self, progress):
         previous_progress = 0
 
         for cache_class in self.caches_array:
@@ -683,6 +728,8 @@ class Cache(object):
         for cache_class in self.caches_array:
             cache_class_name = cache_class.__name__
             cachefile = self.getCacheFile(cache_class.cachefile)
+            for key in [k for k in resident_caches if any(f[0] == cachefile for f in k)]:
+                del resident_caches[key]
             self.logger.debug2("Writing %s", cachefile)
             with open(cachefile, "wb") as f:
                 p = pickle.Pickler(f, pickle.HIGHEST_PROTOCOL)
@@ -5,6 +5,7 @@
 # SPDX-License-Identifier: GPL-2.0-only
 #
 
+import concurrent.futures
 import glob
 import operator
 import os
@@ -48,23 +49,82 @@ class FileChecksumCache(MultiProcessCache):
     cache_file_name = "local_file_checksum_cache.dat"
     CACHE_VERSION = 1
 
+    # Extended attribute used to memoize checksums on the files themselves so
+    # they survive across build directories and cache invalidation. The value
+    # is "<inode>:<mtime_ns>:<size>:<md5>" and is only trusted if the first
+    # three fields still match the file.
+    checksum_xattr = "user.bitbake.md5"
+
     def __init__(self):
         self.mtime_cache = FileMtimeCache()
+        self.threads = 1
+        self.use_xattr = False
         MultiProcessCache.__init__(self)
 
-    def get_checksum(self, f):
-        f = os.path.normpath(f)
+    def setup_workers(self, d):
+        """Set the number of threads used to checksum cache misses and
+        whether checksums are memoized in extended attributes, from
+        BB_NUMBER_CHECKSUM_THREADS and BB_HASH_CHECKSUM_XATTR"""
+        threads = d.getVar("BB_NUMBER_CHECKSUM_THREADS")
+        if threads:
+            try:
+                threads = int(threads)
+            except ValueError:
+                bb.fatal("BB_NUMBER_CHECKSUM_THREADS must be an integer, not '%s'" % threads)
+        else:
+            threads = os.cpu_count() or 1
+        self.threads = max(1, threads)
+        self.use_xattr = bb.utils.to_boolean(d.getVar("BB_HASH_CHECKSUM_XATTR"), False)
+
+    def _cached_checksum(self, f):
+        """Return (mtime, checksum) for f, with checksum None on a cache miss"""
         entry = self.cachedata[0].get(f)
         cmtime = self.mtime_cache.cached_mtime(f)
         if entry:
             (mtime, hashval) = entry
             if cmtime == mtime:
-                return hashval
+                return cmtime, hashval
             else:
                 bb.debug(2, "file %s changed mtime, recompute checksum" % f)
+        return cmtime, None
+
+    def _compute_checksum(self, f):
+        # Called from worker threads, so must not touch the cache dictionaries
+        if not self.use_xattr:
+            return bb.utils.md5_file(f)
+
+        try:
+            # bb.xattr loads libc when imported, so only do so when enabled
+            from bb import xattr
+        except OSError:
+            self.use_xattr = False
+            return bb.utils.md5_file(f)
+
+        st = os.stat(f)
+        key = "%d:%d:%d" % (st.st_ino, st.st_mtime_ns, st.st_size)
+        try:
+            value = xattr.getxattr(f, self.checksum_xattr)
+        except OSError:
+            value = None
+        if value:
+            (xkey, _, hashval) = value.decode("utf-8", "replace").rpartition(":")
+            if xkey == key:
+                return hashval
 
         hashval = bb.utils.md5_file(f)
-        self.cachedata_extras[0][f] = (cmtime, hashval)
+        try:
+            xattr.setxattr(f, self.checksum_xattr, "%s:%s" % (key, hashval))
+        except OSError:
+            # Read-only or xattr-less filesystems just don't get memoized
+            pass
+        return hashval
+
+    def get_checksum(self, f):
+        f = os.path.normpath(f)
+        cmtime, hashval = self._cached_checksum(f)
+        if hashval is None:
+            hashval = self._compute_checksum(f)
+            self.cachedata_extras[0][f] = (cmtime, hashval)
         return hashval
 
     def merge_data(self, source, dest):
@@ -81,11 +141,16 @@ class FileChecksumCache(MultiProcessCache):
         """Get checksums for a list of files"""
 
         def checksum_file(f):
+            # Returns the checksum, or a (path,) placeholder if it has to be computed
             try:
-                checksum = self.get_checksum(f)
+                nf = os.path.normpath(f)
+                cmtime, checksum = self._cached_checksum(nf)
             except OSError as e:
                 bb.warn("Unable to get checksum for %s SRC_URI entry %s: %s" % (pn, os.path.basename(f), e))
                 return None
+            if checksum is None:
+                misses[nf] = cmtime
+                return (nf,)
             return checksum
 
         #
@@ -112,6 +177,7 @@ class FileChecksumCache(MultiProcessCache):
             return dirchecksums
 
         checksums = []
+        misses = {}
         for pth in filelist_regex.split(filelist):
             if not pth:
                 continue
@@ -140,5 +206,36 @@ class FileChecksumCache(MultiProcessCache):
                 if checksum:
                     checksums.append((pth, checksum))
 
+        # Compute any checksums missing from the cache, in parallel if there
+        # is more than one of them
+        if misses:
+            computed = {}
+            def compute(f):
+                try:
+                    computed[f] = self._compute_checksum(f)
+                except OSError as e:
+                    bb.warn("Unable to get checksum for %s SRC_URI entry %s: %s" % (pn, os.path.basename(f), e))
+                    computed[f] = None
+
+            if self.threads > 1 and len(misses) > 1:
+                with concurrent.futures.ThreadPoolExecutor(max_workers=min(self.threads, len(misses))) as executor:
+                    list(executor.map(compute, misses))
+            else:
+                for f in misses:
+                    compute(f)
+
+            for f, checksum in computed.items():
+                if checksum:
+                    self.cachedata_extras[0][f] = (misses[f], checksum)
+
+            resolved = []
+            for (f, checksum) in checksums:
+                if isinstance(checksum, tuple):
+                    checksum = computed[checksum[0]]
+                    if not checksum:
+                        continue
+                resolved.append((f, checksum))
+            checksums = resolved
+
         checksums.sort(key=operator.itemgetter(1))
         return checksums
@@ -187,6 +187,15 @@ def print_ui_queue():
             logger.removeHandler(stdout)
         ui_queue = []
 
+def _send_ui_event(handler, event):
+    # We use pickle here since it better handles object instances
+    # which xmlrpc's marshaller does not. Events *must* be serializable
+    # by pickle.
+    if hasattr(handler, "sendpickle"):
+        handler.sendpickle((pickle.dumps(event)))
+    else:
+        handler.send(event)
+
 def fire_ui_handlers(event, d):
     global _thread_lock
 
@@ -202,13 +211,70 @@ def fire_ui_handlers(event, d):
             try:
                  if not _ui_logfilters[h].filter(event):
                      continue
-                 # We use pickle here since it better handles object instances
-                 # which xmlrpc's marshaller does not. Events *must* be serializable
-                 # by pickle.
-                 if hasattr(_ui_handlers[h].event, "sendpickle"):
-                    _ui_handlers[h].event.sendpickle((pickle.dumps(event)))
-                 else:
-                    _ui_handlers[h].event.send(event)
+                 _send_ui_event(_ui_handlers[h].event, event)
+            except:
+                errors.append(h)
+        for h in errors:
+            del _ui_handlers[h]
+
+class EventBatch(list):
+    """A list of events sent to a UI handler as a single message"""
+
+def coalesce_events(events):
+    """
+    Drop TaskProgress events which are superseded by a later TaskProgress
+    from the same task within the same group of events. Only the most recent
+    progress value is ever displayed so the earlier ones are just overhead.
+    """
+    import bb.build
+
+    superseded = set()
+    coalesced = []
+    for event in reversed(events):
+        pid = getattr(event, "pid", None)
+        if isinstance(event, bb.build.TaskProgress):
+            if pid in superseded:
+                continue
+            superseded.add(pid)
+        else:
+            # Anything else from the task (e.g. TaskSucceeded) ends the run
+            # of progress events which can be merged
+            superseded.discard(pid)
+        coalesced.append(event)
+    coalesced.reverse()
+    return coalesced
+
+def fire_ui_handlers_batch(events, d):
+    """
+    Fire a group of events at the UI handlers. Handlers whose class sets
+    supports_batch receive the filtered events as a single EventBatch
+    message through sendbatch(), with superseded TaskProgress events
+    dropped. Others receive every event, one at a time.
+    """
+    global _thread_lock
+
+    if not _uiready:
+        ui_queue.extend(events)
+        return
+
+    with bb.utils.lock_timeout(_thread_lock):
+        errors = []
+        coalesced = None
+        for h in _ui_handlers:
+            try:
+                handler = _ui_handlers[h].event
+                # Checked on the type since xmlrpc proxies of remote UIs
+                # claim to have any attribute
+                if getattr(type(handler), "supports_batch", False):
+                    if coalesced is None:
+                        coalesced = coalesce_events(events)
+                    filtered = [event for event in coalesced if _ui_logfilters[h].filter(event)]
+                    if filtered:
+                        handler.sendbatch(EventBatch(filtered))
+                else:
+                    for event in events:
+                        if _ui_logfilters[h].filter(event):
+                            _send_ui_event(handler, event)
             except:
                 errors.append(h)
         for h in errors:
@@ -229,14 +295,17 @@ def fire(event, d):
         # If messages have been queued up, clear the queue
         global _uiready, ui_queue
         if _uiready and ui_queue:
-            for queue_event in ui_queue:
-                fire_ui_handlers(queue_event, d)
+            queued = ui_queue
             ui_queue = []
+            fire_ui_handlers_batch(queued, d)
         fire_ui_handlers(event, d)
 
 def fire_from_worker(event, d):
     fire_ui_handlers(event, d)
 
+def fire_from_worker_batch(events, d):
+    fire_ui_handlers_batch(events, d)
+
 noop = lambda _: None
 def register(name, handler, mask=None, filename=None, lineno=None, data=None):
     """Register an Event handler"""
@@ -519,6 +519,7 @@ def fetcher_init(d):
         raise FetchError("Invalid SRCREV cache policy of: %s" % srcrev_policy)
 
     _checksum_cache.init_cache(d.getVar("BB_CACHEDIR"))
+    _checksum_cache.setup_workers(d)
 
     for m in methods:
         if hasattr(m, "init"):
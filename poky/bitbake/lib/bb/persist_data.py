@@ -19,6 +19,8 @@ import logging
 import os.path
 import sqlite3
 import sys
+import threading
+import weakref
 from collections.abc import Mapping
 
 sqlversion = sqlite3.sqlite_version_info
@@ -167,9 +169,9 @@ class SQLTable(collections.abc.MutableMapping):
     @_Decorators.retry()
     @_Decorators.transaction
     def __delitem__(self, cursor, key):
-        if key not in self:
-            raise KeyError(key)
         cursor.execute("DELETE from %s where key=?;" % self.table, [key])
+        if cursor.rowcount == 0:
+            raise KeyError(key)
 
     @_Decorators.retry()
     @_Decorators.transaction
@@ -179,15 +181,10 @@ class SQLTable(collections.abc.MutableMapping):
         elif not isinstance(value, str):
             raise TypeError('Only string values are supported')
 
-        # Ensure the entire transaction (including SELECT) executes under write lock
-        cursor.execute("BEGIN EXCLUSIVE")
-
-        cursor.execute("SELECT * from %s where key=?;" % self.table, [key])
-        row = cursor.fetchone()
-        if row is not None:
-            cursor.execute("UPDATE %s SET value=? WHERE key=?;" % self.table, [value, key])
-        else:
-            cursor.execute("INSERT into %s(key, value) values (?, ?);" % self.table, [key, value])
+        # A single statement takes the write lock only for as long as the
+        # write itself, rather than holding an exclusive lock across a
+        # SELECT followed by an UPDATE or INSERT
+        cursor.execute("INSERT OR REPLACE into %s(key, value) values (?, ?);" % self.table, [key, value])
 
     @_Decorators.retry()
     @_Decorators.transaction
@@ -238,6 +235,45 @@ class SQLTable(collections.abc.MutableMapping):
     def has_key(self, key):
         return key in self
 
+# Tables handed out by persist(), so that repeated lookups (e.g. one per
+# SRCREV during parsing) reuse an open connection instead of connecting and
+# setting up the database every time. Connections can't be shared between
+# threads or carried across a fork, so the cache is per thread and per pid.
+_tables = threading.local()
+
+# Closing a connection opened by another process can corrupt the database,
+# so tables inherited over a fork are kept referenced (and hence open) for
+# the lifetime of the child rather than being collected with its cache.
+_live_tables = weakref.WeakValueDictionary()
+_inherited_tables = []
+
+def _after_fork():
+    _inherited_tables.extend(_live_tables.values())
+    _live_tables.clear()
+
+os.register_at_fork(after_in_child=_after_fork)
+
+def _cached_table(cachefile, domain):
+    if getattr(_tables, "pid", None) != os.getpid():
+        _tables.pid = os.getpid()
+        _tables.cache = {}
+
+    try:
+        ino = os.stat(cachefile).st_ino
+    except OSError:
+        ino = None
+
+    key = (cachefile, domain)
+    entry = _tables.cache.get(key)
+    if entry is not None and ino is not None and entry[0] == ino:
+        return entry[1]
+
+    # New, or the database was removed from under us
+    table = SQLTable(cachefile, domain)
+    _live_tables[id(table)] = table
+    _tables.cache[key] = (os.stat(cachefile).st_ino, table)
+    return table
+
 def persist(domain, d):
     """Convenience factory for SQLTable objects based upon metadata"""
     import bb.utils
@@ -251,7 +287,7 @@ def persist(domain, d):
     cachefile = os.path.join(cachedir, "bb_persist_data.sqlite3")
 
     try:
-        return SQLTable(cachefile, domain)
+        return _cached_table(cachefile, domain)
     except sqlite3.OperationalError:
         # Sqlite fails to open database when its path is too long.
         # After testing, 504 is the biggest path length that can be opened by
@@ -1256,16 +1256,23 @@ class RunQueueData:
 
         bb.parse.siggen.set_setscene_tasks(self.runq_setscene_tids)
 
-        # Iterate over the task list and call into the siggen code
-        dealtwith = set()
-        todeal = set(self.runtaskentries)
-        while todeal:
-            for tid in todeal.copy():
-                if not (self.runtaskentries[tid].depends - dealtwith):
-                    dealtwith.add(tid)
-                    todeal.remove(tid)
-                    self.prepare_task_hash(tid)
-                bb.event.check_for_interrupts(self.cooker.data)
+        # Iterate over the task list in dependency order and call into the siggen code.
+        # Track the number of unhashed dependencies per task so each task is visited
+        # exactly once rather than rescanning the whole remaining set on every pass.
+        deps_left = {}
+        ready = []
+        for tid in self.runtaskentries:
+            deps_left[tid] = len(self.runtaskentries[tid].depends)
+            if not deps_left[tid]:
+                ready.append(tid)
+        while ready:
+            tid = ready.pop()
+            self.prepare_task_hash(tid)
+            for revdep in self.runtaskentries[tid].revdeps:
+                deps_left[revdep] -= 1
+                if not deps_left[revdep]:
+                    ready.append(revdep)
+            bb.event.check_for_interrupts(self.cooker.data)
 
         bb.parse.siggen.writeout_file_checksum_cache()
 
@@ -2460,20 +2467,29 @@ class RunQueueExecute:
                 next |= self.rqdata.runtaskentries[ntid].revdeps
             next.difference_update(total)
 
-        # Now iterate those tasks in dependency order to regenerate their taskhash/unihash
+        # Now iterate those tasks in dependency order to regenerate their taskhash/unihash.
+        # Only tasks with a dependency whose unihash actually changed (the dirty set) need
+        # rehashing, so propagation stops as soon as a task's unihash comes out unchanged.
+        dirty = set(toprocess)
+        deps_left = {}
         next = set()
         for p in total:
-            if not self.rqdata.runtaskentries[p].depends:
-                next.add(p)
-            elif self.rqdata.runtaskentries[p].depends.isdisjoint(total):
+            deps_left[p] = len(self.rqdata.runtaskentries[p].depends & total)
+            if not deps_left[p]:
                 next.add(p)
 
-        # When an item doesn't have dependencies in total, we can process it. Drop items from total when handled
+        # When an item doesn't have unprocessed dependencies in total, we can process it
+        skipped = 0
         while next:
-            current = next.copy()
+            current = next
             next = set()
             for tid in current:
-                if self.rqdata.runtaskentries[p].depends and not self.rqdata.runtaskentries[tid].depends.isdisjoint(total):
+                for revdep in self.rqdata.runtaskentries[tid].revdeps:
+                    deps_left[revdep] -= 1
+                    if not deps_left[revdep]:
+                        next.add(revdep)
+                if self.rqdata.runtaskentries[tid].depends.isdisjoint(dirty):
+                    skipped += 1
                     continue
                 orighash = self.rqdata.runtaskentries[tid].hash
                 newhash = bb.parse.siggen.get_taskhash(tid, self.rqdata.runtaskentries[tid].depends, self.rqdata.dataCaches)
@@ -2496,9 +2512,11 @@ class RunQueueExecute:
                     self.rqdata.runtaskentries[tid].unihash = newuni
                     changed.add(tid)
 
-                next |= self.rqdata.runtaskentries[tid].revdeps
-                total.remove(tid)
-                next.intersection_update(total)
+                if newuni != origuni:
+                    dirty.add(tid)
+
+        if skipped:
+            hashequiv_logger.debug("Skipped rehashing %d of %d dependent tasks with unchanged inputs" % (skipped, len(total)))
 
         if changed:
             for mc in self.rq.worker:
@@ -3185,39 +3203,48 @@ class runQueuePipe():
             if e.errno != errno.EAGAIN:
                 raise
         end = len(self.queue)
+        # Parse with a moving offset and trim the consumed data in one go rather
+        # than copying the remainder of the buffer after every message
         found = True
         while found and self.queue:
             found = False
-            index = self.queue.find(b"</event>")
-            while index != -1 and self.queue.startswith(b"<event>"):
+            pos = 0
+            events = []
+            index = self.queue.find(b"</event>", pos)
+            while index != -1 and self.queue.startswith(b"<event>", pos):
                 try:
-                    event = pickle.loads(self.queue[7:index])
+                    event = pickle.loads(self.queue[pos+7:index])
                 except (ValueError, pickle.UnpicklingError, AttributeError, IndexError) as e:
                     if isinstance(e, pickle.UnpicklingError) and "truncated" in str(e):
                         # The pickled data could contain "</event>" so search for the next occurance
                         # unpickling again, this should be the only way an unpickle error could occur
                         index = self.queue.find(b"</event>", index + 1)
                         continue
-                    bb.msg.fatal("RunQueue", "failed load pickle '%s': '%s'" % (e, self.queue[7:index]))
-                bb.event.fire_from_worker(event, self.d)
+                    bb.msg.fatal("RunQueue", "failed load pickle '%s': '%s'" % (e, self.queue[pos+7:index]))
+                events.append(event)
                 if isinstance(event, taskUniHashUpdate):
                     self.rqexec.updated_taskhash_queue.append((event.taskid, event.unihash))
                 found = True
-                self.queue = self.queue[index+8:]
-                index = self.queue.find(b"</event>")
+                pos = index + 8
+                index = self.queue.find(b"</event>", pos)
+            # Trim before calling out in case anything re-enters read()
+            del self.queue[:pos]
+            if events:
+                # Everything read in one go reaches the UI as a single message
+                bb.event.fire_from_worker_batch(events, self.d)
             index = self.queue.find(b"</exitcode>")
             while index != -1 and self.queue.startswith(b"<exitcode>"):
                 try:
                     task, status = pickle.loads(self.queue[10:index])
                 except (ValueError, pickle.UnpicklingError, AttributeError, IndexError) as e:
                     bb.msg.fatal("RunQueue", "failed load pickle '%s': '%s'" % (e, self.queue[10:index]))
+                del self.queue[:index+11]
                 (_, _, _, taskfn) = split_tid_mcfn(task)
                 fakerootlog = None
                 if self.fakerootlogs and taskfn and taskfn in self.fakerootlogs:
                     fakerootlog = self.fakerootlogs[taskfn]
                 self.rqexec.runqueue_process_waitpid(task, status, fakerootlog=fakerootlog)
                 found = True
-                self.queue = self.queue[index+11:]
                 index = self.queue.find(b"</exitcode>")
         return (end > start)
 
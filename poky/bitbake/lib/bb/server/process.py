@@ -16,6 +16,7 @@ import logging
 import multiprocessing
 import threading
 import array
+import collections
 import os
 import sys
 import time
@@ -760,7 +761,7 @@ def recvfds(sock, size):
 class BBUIEventQueue:
     def __init__(self, readfd):
 
-        self.eventQueue = []
+        self.eventQueue = collections.deque()
         self.eventQueueLock = threading.Lock()
         self.eventQueueNotify = threading.Event()
 
@@ -775,7 +776,7 @@ class BBUIEventQueue:
             if len(self.eventQueue) == 0:
                 return None
 
-            item = self.eventQueue.pop(0)
+            item = self.eventQueue.popleft()
             if len(self.eventQueue) == 0:
                 self.eventQueueNotify.clear()
 
@@ -790,6 +791,11 @@ class BBUIEventQueue:
             self.eventQueue.append(event)
             self.eventQueueNotify.set()
 
+    def queue_events(self, events):
+        with bb.utils.lock_timeout(self.eventQueueLock):
+            self.eventQueue.extend(events)
+            self.eventQueueNotify.set()
+
     def send_event(self, event):
         self.queue_event(pickle.loads(event))
 
@@ -800,7 +806,10 @@ class BBUIEventQueue:
                 ready = self.reader.wait(0.25)
                 if ready:
                     event = self.reader.get()
-                    self.queue_event(event)
+                    if isinstance(event, bb.event.EventBatch):
+                        self.queue_events(event)
+                    else:
+                        self.queue_event(event)
             except (EOFError, OSError, TypeError):
                 # Easiest way to exit is to close the file descriptor to cause an exit
                 break
@@ -834,6 +843,8 @@ class ConnectionReader(object):
 
 
 class ConnectionWriter(object):
+    # Events can be sent as an EventBatch, see sendbatch()
+    supports_batch = True
 
     def __init__(self, fd):
         self.writer = multiprocessing.connection.Connection(fd, readable=False)
@@ -867,6 +878,10 @@ class ConnectionWriter(object):
         else:
             self._send(obj)
 
+    def sendbatch(self, events):
+        # A batch is pickled and written as one message, see bb.event.fire_ui_handlers_batch()
+        self.send(events)
+
     def fileno(self):
         return self.writer.fileno()
 
@@ -207,6 +207,7 @@ class SignatureGeneratorBasic(SignatureGenerator):
         if checksum_cache_file:
             self.checksum_cache = FileChecksumCache()
             self.checksum_cache.init_cache(data, checksum_cache_file)
+            self.checksum_cache.setup_workers(data)
         else:
             self.checksum_cache = None
 
@@ -0,0 +1,114 @@
+#
+# BitBake Tests for the recipe cache (cache.py)
+#
+# Copyright BitBake Contributors
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+
+import os
+import tempfile
+import types
+import unittest
+import bb
+import bb.cache
+import bb.data
+
+class TestRecipeInfo(bb.cache.RecipeInfoCommon):
+    cachefile = "bb_test_cache.dat"
+
+    def __init__(self, value):
+        self.value = value
+
+    @classmethod
+    def init_cacheData(cls, cachedata):
+        pass
+
+class ResidentCacheTest(unittest.TestCase):
+    def setUp(self):
+        self.tempdir = tempfile.TemporaryDirectory()
+        self.d = bb.data.init()
+        self.d.setVar("CACHE", self.tempdir.name)
+        self.databuilder = types.SimpleNamespace(data=self.d)
+        bb.cache.resident_caches.clear()
+
+    def tearDown(self):
+        bb.cache.resident_caches.clear()
+        self.tempdir.cleanup()
+
+    def _cache(self, data_hash="abc"):
+        return bb.cache.Cache(self.databuilder, "", data_hash, [TestRecipeInfo])
+
+    def _write(self, data_hash, recipes):
+        cache = self._cache(data_hash)
+        cache.depends_cache = {fn: [TestRecipeInfo(v)] for fn, v in recipes.items()}
+        cache.cacheclean = False
+        cache.sync()
+
+    def _load(self, data_hash="abc"):
+        cache = self._cache(data_hash)
+        cache.cachefile = cache.getCacheFile("bb_cache.dat")
+        loaded = cache.load_cachefile(lambda p: None)
+        return cache, loaded
+
+    def test_disabled(self):
+        self._write("abc", {"a.bb": 1, "b.bb": 2})
+        cache, loaded = self._load()
+        self.assertEqual(loaded, 2)
+        self.assertEqual(len(bb.cache.resident_caches), 0)
+
+    def test_resident(self):
+        self.d.setVar("BB_SERVER_RESIDENT_CACHES", "1")
+        self._write("abc", {"a.bb": 1, "b.bb": 2})
+        cache, loaded = self._load()
+        self.assertEqual(loaded, 2)
+        self.assertEqual(len(bb.cache.resident_caches), 1)
+        first = cache.depends_cache["a.bb"][0]
+
+        # Second load is served from memory and is independent of the first
+        del cache.depends_cache["a.bb"]
+        cache, loaded = self._load()
+        self.assertEqual(loaded, 2)
+        self.assertIs(cache.depends_cache["a.bb"][0], first)
+
+        # Loading a different configuration evicts the oldest one
+        self._write("def", {"c.bb": 3})
+        cache, loaded = self._load("def")
+        self.assertEqual(loaded, 1)
+        self.assertEqual(len(bb.cache.resident_caches), 1)
+        cache, loaded = self._load()
+        self.assertIsNot(cache.depends_cache["a.bb"][0], first)
+
+    def test_limit_lowered(self):
+        self.d.setVar("BB_SERVER_RESIDENT_CACHES", "2")
+        self._write("abc", {"a.bb": 1})
+        self._write("def", {"c.bb": 3})
+        self._load()
+        self._load("def")
+        self.assertEqual(len(bb.cache.resident_caches), 2)
+
+        # Lowering the limit trims what is already resident on the next load
+        self.d.setVar("BB_SERVER_RESIDENT_CACHES", "1")
+        self._load()
+        self.assertEqual(len(bb.cache.resident_caches), 1)
+
+        # ...and disabling it drops everything
+        self.d.delVar("BB_SERVER_RESIDENT_CACHES")
+        cache, loaded = self._load()
+        self.assertEqual(loaded, 1)
+        self.assertEqual(len(bb.cache.resident_caches), 0)
+
+    def test_invalid_limit(self):
+        self.d.setVar("BB_SERVER_RESIDENT_CACHES", "lots")
+        self._write("abc", {"a.bb": 1})
+        with self.assertRaises(bb.BBHandledException):
+            self._load()
+
+    def test_rewritten(self):
+        self.d.setVar("BB_SERVER_RESIDENT_CACHES", "2")
+        self._write("abc", {"a.bb": 1})
+        self._load()
+        self._write("abc", {"a.bb": 1, "b.bb": 2})
+        self.assertEqual(len(bb.cache.resident_caches), 0)
+        cache, loaded = self._load()
+        self.assertEqual(loaded, 2)
@@ -0,0 +1,124 @@
+#
+# BitBake Tests for the local file checksum cache (checksum.py)
+#
+# Copyright BitBake Contributors
+#
+# SPDX-License-Identifier: GPL-2.0-only
+#
+
+import os
+import tempfile
+import unittest
+import unittest.mock
+import bb
+import bb.checksum
+import bb.data
+import bb.utils
+import bb.xattr
+
+class FileChecksumCacheTest(unittest.TestCase):
+    def setUp(self):
+        self.tempdir = tempfile.TemporaryDirectory()
+        self.srcdir = os.path.join(self.tempdir.name, "files")
+        os.makedirs(os.path.join(self.srcdir, "sub"))
+        self.files = {}
+        for name in ("a.conf", "b.conf", "sub/c.conf", "sub/d.conf"):
+            path = os.path.join(self.srcdir, name)
+            with open(path, "w") as f:
+                f.write("contents of %s\n" % name)
+            self.files[name] = bb.utils.md5_file(path)
+
+    def tearDown(self):
+        self.tempdir.cleanup()
+
+    def _cache(self, threads=1, use_xattr=False):
+        cache = bb.checksum.FileChecksumCache()
+        cache.init_cache(os.path.join(self.tempdir.name, "cache"))
+        d = bb.data.init()
+        d.setVar("BB_NUMBER_CHECKSUM_THREADS", str(threads))
+        d.setVar("BB_HASH_CHECKSUM_XATTR", "1" if use_xattr else "0")
+        cache.setup_workers(d)
+        return cache
+
+    def _filelist(self):
+        return "%s:True %s:True" % (os.path.join(self.srcdir, "a.conf"), os.path.join(self.srcdir, "sub"))
+
+    def _expected(self):
+        expected = [(os.path.join(self.srcdir, "a.conf"), self.files["a.conf"])]
+        for name in ("c.conf", "d.conf"):
+            expected.append((os.path.join(self.srcdir, "sub", ".", name), self.files["sub/" + name]))
+        return sorted(expected, key=lambda x: x[1])
+
+    def test_serial(self):
+        cache = self._cache()
+        self.assertEqual(cache.get_checksums(self._filelist(), "test", []), self._expected())
+
+    def test_parallel(self):
+        cache = self._cache(threads=4)
+        self.assertEqual(cache.get_checksums(self._filelist(), "test", []), self._expected())
+        # Results computed by the workers end up in the persistent cache
+        self.assertEqual(len(cache.cachedata_extras[0]), 3)
+        cache.save_extras()
+        cache.save_merge()
+
+        cache = self._cache(threads=4)
+        self.assertEqual(len(cache.cachedata[0]), 3)
+        self.assertEqual(cache.get_checksums(self._filelist(), "test", []), self._expected())
+        self.assertEqual(len(cache.cachedata_extras[0]), 0)
+
+    def test_missing_file(self):
+        cache = self._cache(threads=4)
+        filelist = "%s:True %s:True" % (os.path.join(self.srcdir, "a.conf"), os.path.join(self.srcdir, "missing.conf"))
+        self.assertEqual(cache.get_checksums(filelist, "test", []),
+                         [(os.path.join(self.srcdir, "a.conf"), self.files["a.conf"])])
+
+    def test_setup_workers(self):
+        cache = bb.checksum.FileChecksumCache()
+        d = bb.data.init()
+        cache.setup_workers(d)
+        self.assertEqual(cache.threads, os.cpu_count() or 1)
+        self.assertFalse(cache.use_xattr)
+
+        d.setVar("BB_NUMBER_CHECKSUM_THREADS", "many")
+        with self.assertRaises(bb.BBHandledException):
+            cache.setup_workers(d)
+
+    def test_xattr_unavailable(self):
+        # Without a usable libc, bb.xattr fails to import and checksums are
+        # computed without memoizing them
+        cache = self._cache(use_xattr=True)
+        path = os.path.join(self.srcdir, "a.conf")
+        with unittest.mock.patch("builtins.__import__", side_effect=self._fail_xattr_import):
+            self.assertEqual(cache.get_checksum(path), self.files["a.conf"])
+        self.assertFalse(cache.use_xattr)
+
+    @staticmethod
+    def _fail_xattr_import(name, globals=None, locals=None, fromlist=(), level=0, _import=__import__):
+        if name == "bb.xattr" or (name == "bb" and "xattr" in (fromlist or ())):
+            raise OSError("libc.so.6: cannot open shared object file")
+        return _import(name, globals, locals, fromlist, level)
+
+    def test_xattr(self):
+        path = os.path.join(self.srcdir, "a.conf")
+        try:
+            bb.xattr.setxattr(path, "user.bitbake.test", "1")
+        except OSError:
+            self.skipTest("Filesystem does not support user extended attributes")
+
+        cache = self._cache(use_xattr=True)
+        self.assertEqual(cache.get_checksum(path), self.files["a.conf"])
+        value = bb.xattr.getxattr(path, cache.checksum_xattr).decode()
+        self.assertTrue(value.endswith(":" + self.files["a.conf"]))
+
+        # A fresh cache trusts the memoized value while the file is unchanged
+        st = os.stat(path)
+        bb.xattr.setxattr(path, cache.checksum_xattr, "%d:%d:%d:%s" % (st.st_ino, st.st_mtime_ns, st.st_size, "f" * 32))
+        cache = self._cache(use_xattr=True)
+        self.assertEqual(cache.get_checksum(path), "f" * 32)
+
+        # ...and ignores it once the file has been modified
+        with open(path, "a") as f:
+            f.write("more\n")
+        os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns + 1000000000))
+        cache = self._cache(use_xattr=True)
+        self.assertEqual(cache.get_checksum(path), bb.utils.md5_file(path))
@@ -13,6 +13,7 @@ import pickle
 import threading
 import time
 import unittest
+import xmlrpc.client
 from unittest.mock import Mock
 from unittest.mock import call
 
@@ -56,6 +57,34 @@ class PickleEventQueueStub(EventQueueStubBase):
         super(PickleEventQueueStub, self)._store_event_data_string(event)
 
 
+class BatchEventQueueStub(EventQueueStubBase):
+    """ Class used as specification for UI event handler queue stub objects
+        with sendbatch method """
+    supports_batch = True
+
+    def __init__(self):
+        super(BatchEventQueueStub, self).__init__()
+        self.batches = 0
+
+    def send(self, event):
+        super(BatchEventQueueStub, self)._store_event_data_string(event)
+
+    def sendbatch(self, events):
+        self.batches += 1
+        for event in events:
+            super(BatchEventQueueStub, self)._store_event_data_string(event)
+
+
+class XMLRPCEventQueueStub(PickleEventQueueStub):
+    """ Class used as specification for remote UI event handler stub objects.
+        Like xmlrpc.client.ServerProxy methods it answers any attribute, but
+        only the sendpickle call is served """
+    def __getattr__(self, name):
+        def remote_call(*args):
+            raise xmlrpc.client.Fault(1, 'method "event.%s" is not supported' % name)
+        return remote_call
+
+
 class UIClientStub(object):
     """ Class used as specification for UI event handler stub objects """
     def __init__(self):
@@ -377,6 +406,80 @@ class EventHandlingTest(unittest.TestCase):
         self.assertEqual(self._test_ui1.event.send.call_args_list,
                          expected)
 
+    def test_fire_ui_handlers_batch(self):
+        """ Test fire_ui_handlers_batch method """
+        mask = ["bb.event.OperationStarted", "bb.event.OperationCompleted"]
+        self._test_ui1.event = BatchEventQueueStub()
+        result = bb.event.register_UIHhandler(self._test_ui1, mainui=True)
+        bb.event.set_UIHmask(result, logging.INFO, {}, mask)
+        self._test_ui2.event = PickleEventQueueStub()
+        result = bb.event.register_UIHhandler(self._test_ui2, mainui=True)
+        bb.event.set_UIHmask(result, logging.INFO, {}, mask)
+
+        events = [bb.event.OperationStarted(),
+                  bb.event.ConfigParsed(),
+                  bb.event.OperationCompleted(total=1)]
+        bb.event.fire_from_worker_batch(events, None)
+        expected = ['OperationStarted', 'OperationCompleted']
+        self.assertEqual(self._test_ui1.event.event_calls, expected)
+        self.assertEqual(self._test_ui1.event.batches, 1)
+        self.assertEqual(self._test_ui2.event.event_calls, expected)
+
+    def test_fire_ui_handlers_batch_coalesce(self):
+        """ Test that only batched UI handlers get coalesced TaskProgress events """
+        import bb.build
+
+        mask = ["bb.build.TaskProgress"]
+        self._test_ui1.event = BatchEventQueueStub()
+        result = bb.event.register_UIHhandler(self._test_ui1, mainui=True)
+        bb.event.set_UIHmask(result, logging.INFO, {}, mask)
+        self._test_ui2.event = PickleEventQueueStub()
+        result = bb.event.register_UIHhandler(self._test_ui2, mainui=True)
+        bb.event.set_UIHmask(result, logging.INFO, {}, mask)
+
+        events = []
+        for value in (10, 20, 30):
+            event = bb.build.TaskProgress(value)
+            event.pid = 1
+            events.append(event)
+        bb.event.fire_from_worker_batch(events, None)
+        self.assertEqual(self._test_ui1.event.event_calls, ['TaskProgress'])
+        self.assertEqual(self._test_ui2.event.event_calls, ['TaskProgress'] * 3)
+
+    def test_fire_ui_handlers_batch_xmlrpc(self):
+        """ Test fire_ui_handlers_batch with a remote (xmlrpc) UI handler """
+        mask = ["bb.event.OperationStarted", "bb.event.OperationCompleted"]
+        self._test_ui1.event = XMLRPCEventQueueStub()
+        self.assertTrue(hasattr(self._test_ui1.event, "sendbatch"))
+        result = bb.event.register_UIHhandler(self._test_ui1, mainui=True)
+        bb.event.set_UIHmask(result, logging.INFO, {}, mask)
+
+        events = [bb.event.OperationStarted(),
+                  bb.event.OperationCompleted(total=1)]
+        bb.event.fire_from_worker_batch(events, None)
+        bb.event.fire_from_worker_batch(events, None)
+        expected = ['OperationStarted', 'OperationCompleted'] * 2
+        self.assertEqual(self._test_ui1.event.event_calls, expected)
+        # The handler must stay registered
+        self.assertIn(result, bb.event._ui_handlers)
+
+    def test_coalesce_events(self):
+        """ Test that superseded TaskProgress events are dropped """
+        import bb.build
+
+        def progress(pid, value):
+            event = bb.build.TaskProgress(value)
+            event.pid = pid
+            return event
+
+        other = bb.event.OperationStarted()
+        other.pid = 1
+        events = [progress(1, 10), progress(2, 10), progress(1, 20),
+                  other, progress(1, 30), progress(2, 20), progress(1, 40)]
+        coalesced = bb.event.coalesce_events(events)
+        self.assertEqual([(e.pid, getattr(e, "progress", None)) for e in coalesced],
+                         [(1, 20), (1, None), (2, 20), (1, 40)])
+
     def test_worker_fire(self):
         """ Test the triggering of bb.event.worker_fire callback """
         bb.event.worker_fire = Mock()
@@ -6,11 +6,14 @@
 # SPDX-License-Identifier: GPL-2.0-only
 #
 
+import gc
 import unittest
 import bb.data
 import bb.persist_data
+import multiprocessing
 import tempfile
 import threading
+import weakref
 
 class PersistDataTest(unittest.TestCase):
     def _create_data(self):
@@ -28,6 +31,8 @@ class PersistDataTest(unittest.TestCase):
                 }
         self.stress_count = 10000
         self.thread_count = 5
+        self.process_stress_count = 50
+        self.process_count = 64
 
         for k,v in self.items.items():
             self.data[k] = v
@@ -127,3 +132,40 @@ class PersistDataTest(unittest.TestCase):
             t.join()
         self._validate_stress()
 
+    def test_stress_processes(self):
+        # Simulates parse/fetch worker processes sharing the database, each
+        # with its own connection
+        ctx = multiprocessing.get_context("fork")
+        # The parent's connection is open across the fork, as in the cooker
+        self.assertIs(self._create_data(), self.data)
+        parent_table = weakref.ref(self.data)
+
+        def worker(i):
+            # Only the persist() cache references the parent's table now. It
+            # must stay alive, since collecting it would close the parent's
+            # connection from this process.
+            del self.data
+            data = self._create_data()
+            self.assertIsNot(data, parent_table())
+            for n in range(self.process_stress_count):
+                data["P%d-%d" % (i, n)] = str(n)
+                data['A1']
+            self.assertIs(self._create_data(), data)
+            gc.collect()
+            self.assertIsNotNone(parent_table())
+
+        procs = [ctx.Process(target=worker, args=(i,)) for i in range(self.process_count)]
+        for p in procs:
+            p.start()
+        for p in procs:
+            p.join()
+            self.assertEqual(p.exitcode, 0)
+
+        # The parent keeps using the connection it held across the fork
+        self.assertIs(self._create_data(), self.data)
+        self.data['D'] = '4'
+        self.assertEqual(self.data['D'], '4')
+        del self.data['D']
+        self.assertEqual(len(self.data), len(self.items) + self.process_count * self.process_stress_count)
+        self.assertEqual(self.data["P%d-%d" % (self.process_count - 1, self.process_stress_count - 1)],
+                         str(self.process_stress_count - 1))
@@ -21,7 +21,7 @@ logger = logging.getLogger(__name__)
 class BBUIEventQueue:
     def __init__(self, BBServer, clientinfo=("localhost, 0")):
 
-        self.eventQueue = []
+        self.eventQueue = collections.deque()
         self.eventQueueLock = threading.Lock()
         self.eventQueueNotify = threading.Event()
 
@@ -73,7 +73,7 @@ class BBUIEventQueue:
         with bb.utils.lock_timeout(self.eventQueueLock):
             if not self.eventQueue:
                 return None
-            item = self.eventQueue.pop(0)
+            item = self.eventQueue.popleft()
             if not self.eventQueue:
                 self.eventQueueNotify.clear()
             return item
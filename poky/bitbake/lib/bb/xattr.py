@@ -84,6 +84,35 @@ def getxattr(path, name, follow=True):
         return arr.raw
 
 
+libc.setxattr.argtypes = [
+    ctypes.c_char_p,
+    ctypes.c_char_p,
+    ctypes.c_char_p,
+    ctypes.c_size_t,
+    ctypes.c_int,
+]
+libc.lsetxattr.argtypes = [
+    ctypes.c_char_p,
+    ctypes.c_char_p,
+    ctypes.c_char_p,
+    ctypes.c_size_t,
+    ctypes.c_int,
+]
+
+
+def setxattr(path, name, value, follow=True):
+    func = libc.setxattr if follow else libc.lsetxattr
+
+    os_path = os.fsencode(path)
+    os_name = os.fsencode(name)
+    if isinstance(value, str):
+        value = value.encode(fsencoding)
+
+    if func(os_path, os_name, value, len(value), 0) < 0:
+        err = ctypes.get_errno()
+        raise OSError(err, os.strerror(err), str(path))
+
+
 def get_all_xattr(path, follow=True):
     attrs = {}
 